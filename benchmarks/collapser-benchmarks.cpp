@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <filesystem>
+
+#include "consensus/cnn-consensus-strategy.h"
+#include "consensus/deep-learning-consensus-caller.h"
+#include "majority-voting-consensus-generator.h"
+#include "msa_bam/bam-to-msa-converter.h"
+#include "synthetic-family-generator.h"
+
+using namespace bfx::read_collapser;
+
+namespace {
+
+// number of inputs copied up front and processed per iteration by the benchmarks that mutate their input
+const size_t kBlockSize = 64;
+
+class DiscardingSink : public ISink<ConsensusRead> {
+ public:
+  void HandleWork(const ConsensusRead&) { benchmark::ClobberMemory(); }
+};
+
+// Args are {depth, read length, indel rate in per mille, partial read percentage}
+SyntheticFamilyGenerator MakeGenerator(const benchmark::State& state) {
+  return SyntheticFamilyGenerator(state.range(0), state.range(1), state.range(2) / 1000.0, state.range(3) / 100.0);
+}
+
+void FamilyArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"depth", "read_length", "indel_permille", "partial_pct"});
+  for (int64_t depth : {10, 50, 200}) {
+    for (int64_t read_length : {150, 300}) {
+      b->Args({depth, read_length, 10, 20});
+    }
+  }
+  b->Args({50, 300, 0, 0});
+  b->Args({50, 300, 50, 50});
+}
+
+// Args are {depth, columns}
+void SoftmaxArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"depth", "columns"});
+  for (int64_t depth : {10, 50, 200}) {
+    for (int64_t columns : {150, 300}) {
+      b->Args({depth, columns});
+    }
+  }
+}
+
+// wall time of f in seconds, for benchmarks that report it through SetIterationTime
+template <typename F>
+double TimeSeconds(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void BM_ConvertBAMtoAlignmentInfo(benchmark::State& state) {
+  auto reads = MakeGenerator(state).Family();
+  BAMtoMSAConverter converter;
+  for (auto _ : state) {
+    AlignmentInfo alignment_info = converter.ConvertBAMtoAlignmentInfo(reads);
+    benchmark::DoNotOptimize(alignment_info);
+  }
+  state.SetItemsProcessed(state.iterations() * reads.size());
+}
+BENCHMARK(BM_ConvertBAMtoAlignmentInfo)->Apply(FamilyArgs);
+
+void BM_TrimAlignmentInfo(benchmark::State& state) {
+  auto reads = MakeGenerator(state).Family();
+  BAMtoMSAConverter converter;
+  AlignmentInfo converted = converter.ConvertBAMtoAlignmentInfo(reads);
+  for (auto _ : state) {
+    AlignmentInfo alignment_info = converter.TrimAlignmentInfo(converted);
+    benchmark::DoNotOptimize(alignment_info);
+  }
+  state.SetItemsProcessed(state.iterations() * reads.size());
+}
+BENCHMARK(BM_TrimAlignmentInfo)->Apply(FamilyArgs);
+
+void BM_DeleteGapMajorColumns(benchmark::State& state) {
+  auto reads = MakeGenerator(state).Family();
+  BAMtoMSAConverter converter;
+  AlignmentInfo converted = converter.ConvertBAMtoAlignmentInfo(reads);
+  for (auto _ : state) {
+    // the copies are made outside the manually timed region
+    std::vector<AlignmentInfo> block(kBlockSize, converted);
+    state.SetIterationTime(TimeSeconds([&] {
+      for (auto& alignment_info : block) {
+        converter.DeleteGapMajorColumns(alignment_info);
+      }
+    }));
+    benchmark::DoNotOptimize(block.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBlockSize * reads.size());
+}
+BENCHMARK(BM_DeleteGapMajorColumns)->Apply(FamilyArgs)->UseManualTime();
+
+void BM_CalculateFeature(benchmark::State& state) {
+  arma::Cube<uint8_t> cluster = MakeGenerator(state).Cluster();
+  for (auto _ : state) {
+    arma::Mat<float> features = CnnConsensusStrategy::CalculateFeature(cluster, 7);
+    benchmark::DoNotOptimize(features.memptr());
+  }
+  state.SetItemsProcessed(state.iterations() * cluster.n_rows * cluster.n_cols);
+}
+BENCHMARK(BM_CalculateFeature)->Apply(FamilyArgs);
+
+void BM_CreateBatches(benchmark::State& state) {
+  auto generator = MakeGenerator(state);
+  std::vector<arma::Cube<uint8_t>> clusters;
+  for (size_t i = 0; i < kBlockSize; i++) {
+    clusters.push_back(generator.Cluster());
+  }
+  for (auto _ : state) {
+    std::vector<float> batch_features;
+    CnnConsensusStrategy::CreateBatches(clusters, batch_features, NUMFEATUREWITHOUTQSCORE, 7);
+    benchmark::DoNotOptimize(batch_features.data());
+  }
+  state.SetItemsProcessed(state.iterations() * clusters.size());
+}
+BENCHMARK(BM_CreateBatches)->Apply(FamilyArgs);
+
+// Softmax post-processing rules over one (columns x 5) slice, as run per cluster after inference
+void PostProcess(const arma::Mat<float>& base_pct, arma::Cube<float>& softmax_value,
+                 const arma::frowvec& num_pass_per_column, size_t n_slice) {
+  CnnConsensusStrategy::NormalizeBaseProb(softmax_value, num_pass_per_column, n_slice);
+  CnnConsensusStrategy::UpdateBasedProbWhereGapIsMajority(base_pct, softmax_value, num_pass_per_column, n_slice);
+  CnnConsensusStrategy::UpdateBasedProbWhereBasePctMeetsMinAF(base_pct, softmax_value, num_pass_per_column, n_slice);
+  CnnConsensusStrategy::UpdateBaseProbWhereGapIsReplaced(base_pct, softmax_value, num_pass_per_column, n_slice);
+  CnnConsensusStrategy::UpdateBaseProbWhereMajorityBaseCountIsTwo(base_pct, softmax_value, num_pass_per_column,
+                                                                  n_slice);
+  CnnConsensusStrategy::UpdateBaseProbWhereMajorityBaseCountIsOne(base_pct, softmax_value, num_pass_per_column,
+                                                                  n_slice);
+  arma::Row<arma::uword> calls = arma::index_max(softmax_value.slice(n_slice), 1).t();
+  arma::Row<float> base_qualities = arma::max(softmax_value.slice(n_slice), 1).t();
+  std::string bases = CnnConsensusStrategy::NumericToDnaBases(calls);
+  auto scores = CnnConsensusStrategy::BaseQualitiesToPhredScores(base_qualities);
+  size_t consensus_length = calls.size();
+  CnnConsensusStrategy::RemoveGapsWithQuality(bases, scores, consensus_length);
+  benchmark::DoNotOptimize(bases.data());
+  benchmark::DoNotOptimize(scores.data());
+}
+
+void BM_SoftmaxPostProcessing(benchmark::State& state) {
+  size_t columns = state.range(1);
+  arma::arma_rng::set_seed(42);
+  arma::Mat<float> base_pct = arma::randu<arma::Mat<float>>(columns, 5);
+  base_pct.each_col() /= arma::sum(base_pct, 1);
+  arma::Cube<float> softmax(columns, 5, 1);
+  softmax.slice(0) = arma::randu<arma::Mat<float>>(columns, 5);
+  softmax.slice(0).each_col() /= arma::sum(softmax.slice(0), 1);
+  arma::frowvec num_pass_per_column(columns);
+  num_pass_per_column.fill(state.range(0));
+  size_t n_slice = 0;
+
+  for (auto _ : state) {
+    // the copies are made outside the manually timed region
+    std::vector<arma::Cube<float>> block(kBlockSize, softmax);
+    state.SetIterationTime(TimeSeconds([&] {
+      for (auto& softmax_value : block) {
+        PostProcess(base_pct, softmax_value, num_pass_per_column, n_slice);
+      }
+    }));
+  }
+  state.SetItemsProcessed(state.iterations() * kBlockSize * columns);
+}
+BENCHMARK(BM_SoftmaxPostProcessing)->Apply(SoftmaxArgs)->UseManualTime();
+
+// End to end CNN consensus on resources/model.onnx: MSA conversion, featurization, ONNX run and post-processing.
+// Each iteration loads the model once (untimed), then times kBatchesPerLoad batches worth of families through a
+// fresh caller including its destruction; the destructor flushes everything still buffered or in flight, so the
+// timing holds whether or not HandleWork runs a batch before returning. The iteration count is fixed so the
+// manually timed milliseconds do not make Google Benchmark reload the model hundreds of times.
+void BM_DeepLearningConsensus(benchmark::State& state) {
+  const int kBatchSize = 32;
+  const int kBatchesPerLoad = 8;
+  auto model = std::filesystem::path(BENCHMARK_RESOURCE_DIR);
+  model.append("model.onnx");
+  auto generator = MakeGenerator(state);
+  std::vector<std::vector<bfx::io::ReadRecordPtr>> families;
+  for (int i = 0; i < kBatchSize * kBatchesPerLoad; i++) {
+    families.push_back(generator.Family(std::to_string(i)));
+  }
+
+  AlignmentOptions alignment_opts(10, 8, 8, 6);
+  auto sink = std::make_shared<DiscardingSink>();
+  for (auto _ : state) {
+    auto cnn_consensus = std::make_unique<CnnConsensusStrategy>(model, false, 1);
+    auto consensus_worker =
+        std::make_shared<DeepLearningConsensusCaller>(std::move(cnn_consensus), 1, kBatchSize, alignment_opts);
+    consensus_worker->AddSink(sink);
+    state.SetIterationTime(TimeSeconds([&] {
+      for (const auto& family : families) {
+        consensus_worker->HandleWork(family);
+      }
+      consensus_worker.reset();
+    }));
+  }
+  state.SetItemsProcessed(state.iterations() * families.size());
+}
+BENCHMARK(BM_DeepLearningConsensus)
+    ->Apply(FamilyArgs)
+    ->UseManualTime()
+    ->Iterations(5)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_DoVoting(benchmark::State& state) {
+  auto reads = MakeGenerator(state).Family();
+  MajorityVotingConsensusGenerator consensus_generator(0.5, 0, 1, {10, 8, 8, 6}, nullptr);
+  for (auto _ : state) {
+    auto result = consensus_generator.DoVoting(reads);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * reads.size());
+}
+BENCHMARK(BM_DoVoting)->Apply(FamilyArgs);
+
+}  // namespace
+
+BENCHMARK_MAIN();
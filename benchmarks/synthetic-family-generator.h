@@ -0,0 +1,142 @@
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "armadillo"
+#include "read-record.h"
+
+namespace bfx::read_collapser {
+
+// Seeded generator of synthetic read families, so every benchmark run sees identical inputs.
+class SyntheticFamilyGenerator {
+ public:
+  SyntheticFamilyGenerator(size_t depth, size_t read_length, double indel_rate, double partial_read_fraction,
+                           uint32_t seed = 42)
+      : depth_(depth),
+        read_length_(read_length),
+        indel_rate_(indel_rate),
+        partial_read_fraction_(partial_read_fraction),
+        rng_(seed) {}
+
+  // Reads sampled from one random template starting at kStart. Indels are single-base and never adjacent to
+  // another indel; partial reads are truncated at their 3' end to between half and all of read_length.
+  std::vector<bfx::io::ReadRecordPtr> Family(const std::string& name = "F") {
+    static const char kBases[] = "ACGT";
+    std::uniform_int_distribution<int> base_dist(0, 3);
+    std::uniform_int_distribution<int> qscore_dist(10, 40);
+    std::uniform_real_distribution<double> unit_dist(0, 1);
+    std::uniform_int_distribution<size_t> partial_length_dist(read_length_ / 2, read_length_);
+
+    std::string reference;
+    for (size_t i = 0; i < read_length_; i++) {
+      reference.push_back(kBases[base_dist(rng_)]);
+    }
+
+    std::vector<bfx::io::ReadRecordPtr> reads;
+    for (size_t i = 0; i < depth_; i++) {
+      size_t length = unit_dist(rng_) < partial_read_fraction_ ? partial_length_dist(rng_) : read_length_;
+      std::string seq;
+      CigarBuilder cigar;
+      size_t ref_pos = 0;
+      bool after_indel = false;
+      while (ref_pos < length) {
+        double roll = unit_dist(rng_);
+        // never start or end on an indel, and always follow one with a match
+        bool indel_allowed = !after_indel && ref_pos > 0 && ref_pos + 1 < length;
+        if (indel_allowed && roll < indel_rate_ / 2) {
+          cigar.Add(bfx::io::Deletion);
+          ref_pos++;
+          after_indel = true;
+        } else if (indel_allowed && roll < indel_rate_) {
+          seq.push_back(kBases[base_dist(rng_)]);
+          cigar.Add(bfx::io::Insert);
+          after_indel = true;
+        } else {
+          seq.push_back(reference[ref_pos]);
+          cigar.Add(bfx::io::ReferenceMatch);
+          ref_pos++;
+          after_indel = false;
+        }
+      }
+      std::vector<uint8_t> qscores;
+      for (size_t j = 0; j < seq.size(); j++) {
+        qscores.push_back(qscore_dist(rng_));
+      }
+      reads.push_back(std::make_shared<bfx::io::ReadRecord>(kStart, kStart + ref_pos, seq.c_str(), cigar.Finish(),
+                                                            FakeRead(), qscores, name));
+    }
+    return reads;
+  }
+
+  // bases/qscores/strands cube in the layout CnnConsensusStrategy::CalculateFeature expects. Covered cells are
+  // ACGT (1-4) except for gaps (0) drawn at indel_rate; partial reads are padded with 7 at their 3' end.
+  arma::Cube<uint8_t> Cluster() {
+    std::uniform_int_distribution<int> base_dist(1, 4);
+    std::uniform_int_distribution<int> qscore_dist(10, 40);
+    std::uniform_int_distribution<int> strand_dist(0, 1);
+    std::uniform_real_distribution<double> unit_dist(0, 1);
+    std::uniform_int_distribution<size_t> partial_length_dist(read_length_ / 2, read_length_);
+
+    arma::Cube<uint8_t> cluster(depth_, read_length_, 3);
+    for (size_t row = 0; row < depth_; row++) {
+      size_t length = unit_dist(rng_) < partial_read_fraction_ ? partial_length_dist(rng_) : read_length_;
+      uint8_t strand = strand_dist(rng_);
+      for (size_t col = 0; col < read_length_; col++) {
+        bool covered = col < length;
+        cluster(row, col, 0) = covered ? (unit_dist(rng_) < indel_rate_ ? 0 : base_dist(rng_)) : 7;
+        cluster(row, col, 1) = covered ? qscore_dist(rng_) : 0;
+        cluster(row, col, 2) = strand;
+      }
+    }
+    return cluster;
+  }
+
+  static constexpr size_t kStart = 100;
+
+ private:
+  // minimal bam1_t the ReadRecord constructor accepts; the generated reads never touch its data
+  static std::shared_ptr<bam1_t> FakeRead() {
+    auto read = new bam1_t();
+    read->data = new uint8_t[]{0};
+    return std::shared_ptr<bam1_t>(read, [](bam1_t* r) {
+      delete[] r->data;
+      delete r;
+    });
+  }
+
+  // run-length encodes one cigar operation at a time
+  class CigarBuilder {
+   public:
+    void Add(bfx::io::CigarOp op) {
+      if (run_ > 0 && op != op_) {
+        entries_.emplace_back(op_, run_);
+        run_ = 0;
+      }
+      op_ = op;
+      run_++;
+    }
+
+    std::vector<bfx::io::CigarEntry> Finish() {
+      if (run_ > 0) {
+        entries_.emplace_back(op_, run_);
+        run_ = 0;
+      }
+      return std::move(entries_);
+    }
+
+   private:
+    std::vector<bfx::io::CigarEntry> entries_;
+    bfx::io::CigarOp op_ = bfx::io::ReferenceMatch;
+    uint32_t run_ = 0;
+  };
+
+  size_t depth_;
+  size_t read_length_;
+  double indel_rate_;
+  double partial_read_fraction_;
+  std::mt19937 rng_;
+};
+
+}  // namespace bfx::read_collapser
@@ -69,6 +69,29 @@ TEST_CASE_METHOD(CnnConsensusStrategyTestFixture, "createBatchesTest") {
   REQUIRE(second_cluster_feature == expected_batch_data);
 }
 
+TEST_CASE_METHOD(CnnConsensusStrategyTestFixture, "createBatchesClusterOffsetsTest") {
+  // five distinct clusters of the same width: the fixture with its columns rotated by i
+  std::vector<arma::Cube<uint8_t>> clusters;
+  for (size_t i = 0; i < 5; i++) {
+    arma::Cube<uint8_t> rotated = arma::join_slices(arma::shift(bases, i, 1), arma::shift(qscores, i, 1));
+    clusters.push_back(arma::join_slices(rotated, arma::shift(strands, i, 1)));
+  }
+  std::vector<float> batch_features;
+  CnnConsensusStrategy::CreateBatches(clusters, batch_features, NUMFEATUREWITHOUTQSCORE, 7);
+
+  // slot i must hold cluster i's own features
+  size_t cluster_size = expected_features.n_elem;
+  REQUIRE(batch_features.size() == clusters.size() * cluster_size);
+  for (size_t i = 0; i < clusters.size(); i++) {
+    arma::Mat<float> cluster_features = CnnConsensusStrategy::CalculateFeature(clusters[i], 7);
+    arma::Col<float> expected_cluster_vector = arma::vectorise(cluster_features.t());
+    std::vector<float> expected_cluster_feature(expected_cluster_vector.begin(), expected_cluster_vector.end());
+    auto cluster_begin = batch_features.begin() + i * cluster_size;
+    std::vector<float> cluster_feature(cluster_begin, cluster_begin + cluster_size);
+    REQUIRE(cluster_feature == expected_cluster_feature);
+  }
+}
+
 // Test fixture struct
 struct CnnConsensusStrategyPartialReadTestFixture {
   arma::Mat<uint8_t> bases;
@@ -103,6 +126,16 @@ TEST_CASE_METHOD(CnnConsensusStrategyPartialReadTestFixture, "calculatePartialRe
   REQUIRE(arma::approx_equal(features, expected_result, "absdiff", 1e-5));
 }
 
+TEST_CASE_METHOD(CnnConsensusStrategyPartialReadTestFixture, "calculateWidePartialReadFeatureTest") {
+  // the 6 fixture columns repeated 50 times; features are per column, so the expected result repeats too
+  arma::Cube<uint8_t> wide_cluster = arma::join_slices(arma::repmat(bases, 1, 50), arma::repmat(qscores, 1, 50));
+  wide_cluster = arma::join_slices(wide_cluster, arma::repmat(strands, 1, 50));
+
+  arma::Mat<float> features = CnnConsensusStrategy::CalculateFeature(wide_cluster, 7);
+  arma::Mat<float> expected_result = arma::repmat(expected_features, 50, 1).t();
+  REQUIRE(arma::approx_equal(features, expected_result, "absdiff", 1e-5));
+}
+
 TEST_CASE_METHOD(CnnConsensusStrategyPartialReadTestFixture, "createPartialReadBatchesTest") {
   arma::Col<float> expected_features_vector = arma::vectorise(expected_features);
   std::vector<float> expected_batch_data(expected_features_vector.begin(), expected_features_vector.end());
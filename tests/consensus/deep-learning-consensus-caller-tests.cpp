@@ -57,6 +57,67 @@ TEST_CASE("Batch") {
   REQUIRE(my_sink->Reads[1].ReadName() == "B-0-0-4-0-4");
 }
 
+static const std::string kSeqA = "ACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGT";
+static const std::string kSeqB = "GTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGTGT";
+
+// feeds one unanimous 4-read family per sequence, named by its index, and checks the sink sees each family's own
+// sequence back in input order
+static void CheckBatchOutputOrder(int threads, int batch_size, const std::vector<std::string>& sequences) {
+  auto model = std::filesystem::path(TEST_RESOURCE_DIR);
+  model.append("model.onnx");
+  auto my_sink = std::make_shared<MyConsensusReadAccumulator>();
+  {
+    auto cnn_consensus = std::make_unique<CnnConsensusStrategy>(model, false, 1);
+    AlignmentOptions alignment_opts(10, 8, 8, 6);
+    auto consensus_worker =
+        std::make_shared<DeepLearningConsensusCaller>(std::move(cnn_consensus), threads, batch_size, alignment_opts);
+    consensus_worker->AddSink(my_sink);
+
+    for (size_t i = 0; i < sequences.size(); i++) {
+      const auto& seq = sequences[i];
+      std::vector<uint8_t> scores(seq.size(), 20);
+      std::vector<bfx::io::CigarEntry> cigar{bfx::io::CigarEntry(bfx::io::CigarOp::ReferenceMatch, seq.size())};
+      int end = 100 + seq.size();
+      auto name = std::to_string(i);
+      consensus_worker->HandleWork(
+          {std::make_shared<bfx::io::ReadRecord>(100, end, seq.c_str(), cigar, make_fake_read(), scores, name),
+           std::make_shared<bfx::io::ReadRecord>(100, end, seq.c_str(), cigar, make_fake_read(), scores, name),
+           std::make_shared<bfx::io::ReadRecord>(100, end, seq.c_str(), cigar, make_fake_read(), scores, name),
+           std::make_shared<bfx::io::ReadRecord>(100, end, seq.c_str(), cigar, make_fake_read(), scores, name)});
+    }
+  }
+  REQUIRE(my_sink->Reads.size() == sequences.size());
+  for (size_t i = 0; i < sequences.size(); i++) {
+    REQUIRE(my_sink->Reads[i].Bases() == sequences[i]);
+    REQUIRE(my_sink->Reads[i].ReadName() == std::to_string(i) + "-0-0-4-0-4");
+  }
+}
+
+// num_families sequences alternating between kSeqA and kSeqB
+static std::vector<std::string> AlternatingSequences(size_t num_families) {
+  std::vector<std::string> sequences;
+  for (size_t i = 0; i < num_families; i++) {
+    sequences.push_back(i % 2 == 0 ? kSeqA : kSeqB);
+  }
+  return sequences;
+}
+
+TEST_CASE("Batch output order across several batches") {
+  // two full batches plus a partial one flushed on destruction
+  CheckBatchOutputOrder(1, 2, AlternatingSequences(5));
+}
+
+TEST_CASE("Batch output order with multiple threads") {
+  CheckBatchOutputOrder(4, 2, AlternatingSequences(13));
+}
+
+TEST_CASE("Batch output order with mixed widths") {
+  // 64 bp and 32 bp families interleaved in input order; output must follow that order whatever the batching
+  std::vector<std::string> sequences = {kSeqA, kSeqA.substr(0, 32), kSeqB, kSeqB.substr(0, 32), kSeqA.substr(0, 32),
+                                        kSeqB, kSeqB.substr(0, 32)};
+  CheckBatchOutputOrder(1, 2, sequences);
+}
+
 TEST_CASE("Batch with default min depth") {
   auto model = std::filesystem::path(TEST_RESOURCE_DIR);
   model.append("model.onnx");
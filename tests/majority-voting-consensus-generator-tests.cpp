@@ -221,3 +221,40 @@ TEST_CASE("Different insertion sequences", "[majority_voting]") {
   auto result = consensusGenerator.DoVoting(reads);
   REQUIRE(get<0>(result) == "ACGTAATACGTACGTACGT");
 }
+
+TEST_CASE("Deep family substitution", "[majority_voting]") {
+  std::vector<bfx::io::ReadRecordPtr> reads;
+  for (size_t i = 0; i < 30; i++) {
+    reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(
+        new bfx::io::ReadRecord(100, 116, "ACGTACGTACGTACGT", {{bfx::io::ReferenceMatch, 16}}, make_fake_read())));
+  }
+  for (size_t i = 0; i < 20; i++) {
+    reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(
+        new bfx::io::ReadRecord(100, 116, "ACGTTCGTACGTACGT", {{bfx::io::ReferenceMatch, 16}}, make_fake_read())));
+  }
+  MajorityVotingConsensusGenerator consensusGenerator(0.5, 0, 1, {10, 8, 8, 6}, nullptr);
+  auto result = consensusGenerator.DoVoting(reads);
+  REQUIRE(get<0>(result) == "ACGTACGTACGTACGT");
+  REQUIRE(result.cigar()[0] == bfx::io::CigarEntry{bfx::io::ReferenceMatch, 16});
+  REQUIRE(result.cigar().size() == 1);
+}
+
+TEST_CASE("Deep family insertion", "[majority_voting]") {
+  std::vector<bfx::io::ReadRecordPtr> reads;
+  for (size_t i = 0; i < 30; i++) {
+    reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+        100, 116, "ACGTAAACGTACGTACGT",
+        {{bfx::io::ReferenceMatch, 4}, {bfx::io::Insert, 2}, {bfx::io::ReferenceMatch, 12}}, make_fake_read())));
+  }
+  for (size_t i = 0; i < 20; i++) {
+    reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(
+        new bfx::io::ReadRecord(100, 116, "ACGTACGTACGTACGT", {{bfx::io::ReferenceMatch, 16}}, make_fake_read())));
+  }
+  MajorityVotingConsensusGenerator consensusGenerator(0.5, 0, 1, {10, 8, 8, 6}, nullptr);
+  auto result = consensusGenerator.DoVoting(reads);
+  REQUIRE(get<0>(result) == "ACGTAAACGTACGTACGT");
+  REQUIRE(result.cigar()[0] == bfx::io::CigarEntry{bfx::io::ReferenceMatch, 4});
+  REQUIRE(result.cigar()[1] == bfx::io::CigarEntry{bfx::io::Insert, 2});
+  REQUIRE(result.cigar()[2] == bfx::io::CigarEntry{bfx::io::ReferenceMatch, 12});
+  REQUIRE(result.cigar().size() == 3);
+}
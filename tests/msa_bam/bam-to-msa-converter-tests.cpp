@@ -276,6 +276,39 @@ TEST_CASE("DeleteGapMajorColumnsWithPartials") {
   REQUIRE(alignment_info.msa == expected_msa);
 }
 
+TEST_CASE("DeleteGapMajorColumnsIsIdempotent") {
+  std::vector<bfx::io::ReadRecordPtr> reads;
+  reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(
+      new bfx::io::ReadRecord(99, 105, "ATGAGTACAG",
+                              {{bfx::io::ReferenceMatch, 3},
+                               {bfx::io::Insert, 2},
+                               {bfx::io::ReferenceMatch, 2},
+                               {bfx::io::Insert, 1},
+                               {bfx::io::ReferenceMatch, 2}},
+                              make_fake_read(), {20, 20, 20, 20, 20, 20, 20, 20, 20, 20})));
+  reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      99, 105, "ATGTAAG", {{bfx::io::ReferenceMatch, 7}}, make_fake_read(), {20, 20, 20, 20, 20, 20, 20})));
+  reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      99, 105, "ATGTAAG", {{bfx::io::ReferenceMatch, 7}}, make_fake_read(), {20, 20, 20, 20, 20, 20, 20})));
+  reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      99, 105, "ATGTAAG", {{bfx::io::ReferenceMatch, 7}}, make_fake_read(), {20, 20, 20, 20, 20, 20, 20})));
+  reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      99, 103, "ATGTA", {{bfx::io::ReferenceMatch, 5}}, make_fake_read(), {20, 20, 20, 20, 20})));
+
+  BAMtoMSAConverter converter;
+  AlignmentInfo alignment_info = converter.ConvertBAMtoAlignmentInfo(reads);
+  converter.DeleteGapMajorColumns(alignment_info);
+  // a second pass over the compacted MSA must not move or drop anything
+  converter.DeleteGapMajorColumns(alignment_info);
+
+  std::vector<std::vector<uint8_t>> expected_msa = {{1, 4, 3, 4, 1, 2, 1, 3},
+                                                    {1, 4, 3, 4, 1, 0, 1, 3},
+                                                    {1, 4, 3, 4, 1, 0, 1, 3},
+                                                    {1, 4, 3, 4, 1, 0, 1, 3},
+                                                    {1, 4, 3, 4, 1, 7, 7, 7}};
+  REQUIRE(alignment_info.msa == expected_msa);
+}
+
 TEST_CASE("CheckDiscardEmptyReads") {
   std::vector<bfx::io::ReadRecordPtr> reads;
   reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
@@ -334,6 +367,28 @@ TEST_CASE("GetGapMajorColumns") {
   REQUIRE(columns == expected_columns);
 }
 
+TEST_CASE("GetGapMajorColumnsWideMSA") {
+  // 70 columns of full coverage with a minority gap in the first row every 7th column, two all-gap columns, and a
+  // last column where only the first row is covered and it is a gap
+  std::vector<std::vector<uint8_t>> msa(4);
+  for (size_t column = 0; column < 69; column++) {
+    for (size_t row = 0; row < msa.size(); row++) {
+      bool gap = column == 20 || column == 45 || (row == 0 && column % 7 == 1);
+      msa[row].push_back(gap ? 0 : 1 + column % 4);
+    }
+  }
+  msa[0].push_back(0);
+  for (size_t row = 1; row < msa.size(); row++) {
+    msa[row].push_back(7);
+  }
+
+  BAMtoMSAConverter converter;
+  std::vector<size_t> expected_columns = {20, 45, 69};
+  std::vector<size_t> columns = converter.GetGapMajorColumns(msa);
+
+  REQUIRE(columns == expected_columns);
+}
+
 TEST_CASE("SetEffectiveNumPass") {
   std::vector<bfx::io::ReadRecordPtr> reads;
   reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
@@ -354,3 +409,65 @@ TEST_CASE("SetEffectiveNumPass") {
   int expected_effective_num_pass = 2;
   REQUIRE(alignment_info.effective_num_pass == expected_effective_num_pass);
 }
+
+TEST_CASE("DeepFamily") {
+  // 67 rows is not a multiple of any vector width; one insertion read plus partial reads interleaved with full ones
+  std::vector<bfx::io::ReadRecordPtr> reads;
+  std::vector<std::vector<uint8_t>> expected_msa;
+  reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(
+      new bfx::io::ReadRecord(99, 105, "ATGAGTACAG",
+                              {{bfx::io::ReferenceMatch, 3},
+                               {bfx::io::Insert, 2},
+                               {bfx::io::ReferenceMatch, 2},
+                               {bfx::io::Insert, 1},
+                               {bfx::io::ReferenceMatch, 2}},
+                              make_fake_read(), {20, 20, 20, 20, 20, 20, 20, 20, 20, 20})));
+  expected_msa.push_back({1, 4, 3, 1, 3, 4, 1, 2, 1, 3});
+  for (size_t i = 0; i < 66; i++) {
+    if (i % 4 == 3) {
+      reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+          99, 103, "ATGTA", {{bfx::io::ReferenceMatch, 5}}, make_fake_read(), {20, 20, 20, 20, 20})));
+      expected_msa.push_back({1, 4, 3, 0, 0, 4, 1, 7, 7, 7});
+    } else {
+      reads.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+          99, 105, "ATGTAAG", {{bfx::io::ReferenceMatch, 7}}, make_fake_read(), {20, 20, 20, 20, 20, 20, 20})));
+      expected_msa.push_back({1, 4, 3, 0, 0, 4, 1, 0, 1, 3});
+    }
+  }
+
+  BAMtoMSAConverter converter;
+  AlignmentInfo alignment_info = converter.ConvertBAMtoAlignmentInfo(reads);
+
+  REQUIRE(alignment_info.msa.size() == 67);
+  REQUIRE(alignment_info.msa == expected_msa);
+}
+
+TEST_CASE("ConverterReuseAcrossFamilies") {
+  std::vector<bfx::io::ReadRecordPtr> wide_family;
+  wide_family.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      99, 106, "TACGTACGTACG",
+      {{bfx::io::SoftClip, 2}, {bfx::io::ReferenceMatch, 4}, {bfx::io::Insert, 2}, {bfx::io::ReferenceMatch, 4}},
+      make_fake_read(), {20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20})));
+  wide_family.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      100, 107, "AGTATAGCGT",
+      {{bfx::io::SoftClip, 1}, {bfx::io::ReferenceMatch, 5}, {bfx::io::Insert, 1}, {bfx::io::ReferenceMatch, 3}},
+      make_fake_read(), {20, 20, 20, 20, 20, 20, 20, 20, 20, 20})));
+  wide_family.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      100, 102, "AGTA", {{bfx::io::SoftClip, 1}, {bfx::io::ReferenceMatch, 3}}, make_fake_read(), {20, 20, 20, 20})));
+
+  std::vector<bfx::io::ReadRecordPtr> narrow_family;
+  narrow_family.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      100, 108, "ACGTACGT", {{bfx::io::ReferenceMatch, 8}}, make_fake_read(), {20, 20, 20, 20, 20, 20, 20, 20})));
+  narrow_family.push_back(std::shared_ptr<bfx::io::ReadRecord>(new bfx::io::ReadRecord(
+      100, 108, "ACGTACGT", {{bfx::io::ReferenceMatch, 8}}, make_fake_read(), {20, 20, 20, 20, 20, 20, 20, 20})));
+
+  std::vector<std::vector<uint8_t>> expected_wide_msa = {
+      {3, 4, 1, 2, 3, 4, 1, 0, 2, 3}, {3, 4, 1, 0, 0, 4, 1, 3, 2, 3}, {3, 4, 1, 7, 7, 7, 7, 7, 7, 7}};
+  std::vector<std::vector<uint8_t>> expected_narrow_msa = {{1, 2, 3, 4, 1, 2, 3, 4}, {1, 2, 3, 4, 1, 2, 3, 4}};
+
+  // one converter handles families of different shapes; nothing may leak from one family into the next
+  BAMtoMSAConverter converter;  // default remove_soft_clips = true
+  REQUIRE(converter.ConvertBAMtoAlignmentInfo(wide_family).msa == expected_wide_msa);
+  REQUIRE(converter.ConvertBAMtoAlignmentInfo(narrow_family).msa == expected_narrow_msa);
+  REQUIRE(converter.ConvertBAMtoAlignmentInfo(wide_family).msa == expected_wide_msa);
+}